@@ -0,0 +1,235 @@
+#include "edge_stream.hh"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <fcntl.h>
+#include <future>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace {
+
+[[noreturn]] void throwErrno(const std::string &what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+void preadFully(int fd, void *data, std::size_t bytes, off_t offset) {
+  auto *out = static_cast<char *>(data);
+  while (bytes > 0) {
+    ssize_t n = ::pread(fd, out, bytes, offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwErrno("Reading edge stream failed");
+    }
+    if (n == 0) {
+      throw std::runtime_error("Edge stream is truncated");
+    }
+    out += n;
+    bytes -= static_cast<std::size_t>(n);
+    offset += n;
+  }
+}
+
+void pwriteFully(int fd, const void *data, std::size_t bytes, off_t offset) {
+  const auto *in = static_cast<const char *>(data);
+  while (bytes > 0) {
+    ssize_t n = ::pwrite(fd, in, bytes, offset);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwErrno("Writing edge stream failed");
+    }
+    in += n;
+    bytes -= static_cast<std::size_t>(n);
+    offset += n;
+  }
+}
+
+constexpr off_t kEdgesOffset = sizeof(EdgeStreamHeader);
+
+} // namespace
+
+EdgeStreamWriter::EdgeStreamWriter(const std::string &path,
+                                   std::size_t node_count, bool directed,
+                                   std::size_t block_edges)
+    : fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+      node_count(node_count), directed(directed),
+      block_edges(std::max<std::size_t>(block_edges, 1)) {
+  if (fd < 0) {
+    throwErrno("Cannot create edge stream " + path);
+  }
+  buffer.reserve(this->block_edges);
+}
+
+EdgeStreamWriter::~EdgeStreamWriter() {
+  try {
+    close();
+  } catch (...) {
+    // Destructors must not throw, call close() explicitly to see errors
+  }
+}
+
+void EdgeStreamWriter::addEdge(NodeUID from, NodeUID to) {
+  if (fd < 0) {
+    throw std::logic_error("Edge stream writer is closed");
+  }
+  if (from >= node_count || to >= node_count) {
+    throw std::out_of_range("Node UID exceeds node count of edge stream");
+  }
+  buffer.push_back({from, to});
+  if (buffer.size() == block_edges) {
+    flush();
+  }
+}
+
+void EdgeStreamWriter::flush() {
+  pwriteFully(fd, buffer.data(), buffer.size() * sizeof(StreamedEdge),
+              kEdgesOffset +
+                  static_cast<off_t>(edge_count * sizeof(StreamedEdge)));
+  edge_count += buffer.size();
+  buffer.clear();
+}
+
+void EdgeStreamWriter::close() {
+  if (fd < 0) {
+    return;
+  }
+  try {
+    flush();
+    EdgeStreamHeader header{kEdgeStreamMagic, node_count, edge_count,
+                            directed ? 1u : 0u};
+    pwriteFully(fd, &header, sizeof(header), 0);
+  } catch (...) {
+    ::close(fd);
+    fd = -1;
+    throw;
+  }
+  int result = ::close(fd);
+  fd = -1;
+  if (result != 0) {
+    throwErrno("Closing edge stream failed");
+  }
+}
+
+EdgeStream::EdgeStream(const std::string &path, std::size_t block_edges)
+    : fd(::open(path.c_str(), O_RDONLY)),
+      block_edges(std::max<std::size_t>(block_edges, 1)) {
+  if (fd < 0) {
+    throwErrno("Cannot open edge stream " + path);
+  }
+  EdgeStreamHeader header{};
+  struct stat file_info {};
+  try {
+    preadFully(fd, &header, sizeof(header), 0);
+    if (::fstat(fd, &file_info) != 0) {
+      throwErrno("Cannot stat edge stream " + path);
+    }
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  if (header.magic != kEdgeStreamMagic) {
+    ::close(fd);
+    throw std::runtime_error(path + " is not an edge stream");
+  }
+  // Compared by division so a corrupt edge count cannot overflow
+  const auto edge_bytes =
+      static_cast<std::uint64_t>(file_info.st_size) - sizeof(header);
+  if (edge_bytes % sizeof(StreamedEdge) != 0 ||
+      edge_bytes / sizeof(StreamedEdge) != header.edge_count) {
+    ::close(fd);
+    throw std::runtime_error(path + " does not match its edge count");
+  }
+  node_count = header.node_count;
+  edge_count = header.edge_count;
+  directed = header.directed != 0;
+#if defined(POSIX_FADV_SEQUENTIAL)
+  // Only a hint, the kernel may use it to read ahead more aggressively
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+EdgeStream::EdgeStream(EdgeStream &&other) noexcept
+    : fd(other.fd), node_count(other.node_count),
+      edge_count(other.edge_count), directed(other.directed),
+      block_edges(other.block_edges) {
+  other.fd = -1;
+}
+
+EdgeStream::~EdgeStream() {
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+void EdgeStream::forEachBlock(
+    const std::function<void(std::span<const StreamedEdge>)> &visit) const {
+  if (edge_count == 0) {
+    return;
+  }
+  const std::size_t buffer_edges = std::min(block_edges, edge_count);
+  // Declared before the future so a pending read never outlives its buffer
+  std::array<std::vector<StreamedEdge>, 2> buffers{
+      std::vector<StreamedEdge>(buffer_edges),
+      std::vector<StreamedEdge>(buffer_edges)};
+
+  auto read_block = [this, &buffers, buffer_edges](std::size_t buffer,
+                                                   std::size_t first) {
+    std::size_t count = std::min(buffer_edges, edge_count - first);
+    preadFully(fd, buffers[buffer].data(), count * sizeof(StreamedEdge),
+               kEdgesOffset + static_cast<off_t>(first * sizeof(StreamedEdge)));
+    // Validated here so the algorithms can index node arrays unchecked. This
+    // runs on the prefetch thread, off the processing path.
+    for (std::size_t i = 0; i < count; ++i) {
+      const StreamedEdge &edge = buffers[buffer][i];
+      if (edge.from >= node_count || edge.to >= node_count) {
+        throw std::runtime_error("Edge " + std::to_string(first + i) +
+                                 " exceeds node count of edge stream");
+      }
+    }
+    return count;
+  };
+
+  std::size_t current = 0;
+  std::size_t next_edge = 0;
+  std::future<std::size_t> pending =
+      std::async(std::launch::async, read_block, current, next_edge);
+  while (next_edge < edge_count) {
+    std::size_t count = pending.get();
+    next_edge += count;
+    if (next_edge < edge_count) {
+      // Prefetch the following block into the other buffer while this one is
+      // being processed
+      pending =
+          std::async(std::launch::async, read_block, current ^ 1, next_edge);
+    }
+    visit(std::span<const StreamedEdge>(buffers[current].data(), count));
+    current ^= 1;
+  }
+}
+
+void writeEdgeStream(const Graph &graph, const std::string &path,
+                     std::size_t block_edges) {
+  std::size_t node_count = 0;
+  for (const auto &[uid, node] : graph.node_list) {
+    node_count = std::max(node_count, uid + 1);
+  }
+  for (const auto &[uid, edge] : graph.edge_list) {
+    node_count = std::max({node_count, edge->from->uid + 1, edge->to->uid + 1});
+  }
+
+  EdgeStreamWriter writer(path, node_count, true, block_edges);
+  for (const auto &[uid, edge] : graph.edge_list) {
+    writer.addEdge(edge->from->uid, edge->to->uid);
+    if (edge->hasTrait(EdgeTypes::UNDIRECTED)) {
+      writer.addEdge(edge->to->uid, edge->from->uid);
+    }
+  }
+  writer.close();
+}
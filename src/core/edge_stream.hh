@@ -0,0 +1,145 @@
+/*
+ * This file defines the on-disk edge source used for semi-external
+ * ("out-of-core") graph processing. In this mode only per-node state is kept
+ * in memory while the edges are streamed from disk in large sequential
+ * blocks. That allows running traversals on graphs whose edge set does not
+ * fit into RAM as long as a handful of arrays of size |V| still do.
+ *
+ * Key components:
+ * - StreamedEdge: The fixed size record an edge is stored as on disk.
+ * - EdgeStreamHeader: The header at the start of every edge stream file.
+ * - EdgeStreamWriter: Appends edges to a new edge stream file. Edges are
+ *   buffered and written in blocks, so the writer itself never needs the full
+ *   edge set in memory.
+ * - EdgeStream: A read-only graph source over an edge stream file. Edges are
+ *   handed out block by block. While one block is being processed the next one
+ *   is already read in the background (double buffering), so computation and
+ *   I/O overlap.
+ * - writeEdgeStream: Dumps an in-memory Graph into an edge stream file.
+ *
+ * Node UIDs in a stream are dense, i.e. every endpoint must be smaller than
+ * the node count stored in the header. EdgeStream checks this for every edge
+ * it reads, so files from other producers cannot cause out-of-bounds access.
+ *
+ *  Time and Space Complexity:
+ * - EdgeStream::forEachBlock: O(|E|) time, O(block_edges) memory.
+ * - EdgeStreamWriter::addEdge: amortized O(1), O(block_edges) memory.
+ */
+#ifndef CORE_EDGE_STREAM_H
+#define CORE_EDGE_STREAM_H
+
+#include "graph.hh"
+#include "typenames.hh"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+struct StreamedEdge {
+  NodeUID from;
+  NodeUID to;
+};
+
+static_assert(sizeof(StreamedEdge) == 2 * sizeof(std::uint64_t),
+              "Edge stream files assume 64 bit node UIDs");
+
+struct EdgeStreamHeader {
+  std::uint64_t magic;
+  std::uint64_t node_count;
+  std::uint64_t edge_count;
+  std::uint64_t directed;
+};
+
+// "GAIESTRM" in little endian, used to reject files that are no edge streams
+inline constexpr std::uint64_t kEdgeStreamMagic = 0x4d52545345494147ULL;
+
+// 1 Mi edges = 16 MiB per block, large enough to keep disks at full
+// sequential throughput
+inline constexpr std::size_t kDefaultEdgeBlockSize = std::size_t{1} << 20;
+
+/*
+ * The EdgeStreamWriter creates an edge stream file and appends edges to it.
+ * The header is finalized when close() is called (or the writer is destroyed).
+ *
+ * Valid Inputs:
+ * - Both endpoints of every added edge must be smaller than node_count.
+ * - For undirected streams every edge is only added once.
+ */
+struct EdgeStreamWriter {
+  EdgeStreamWriter(const std::string &path, std::size_t node_count,
+                   bool directed,
+                   std::size_t block_edges = kDefaultEdgeBlockSize);
+  ~EdgeStreamWriter();
+
+  EdgeStreamWriter(const EdgeStreamWriter &) = delete;
+  EdgeStreamWriter &operator=(const EdgeStreamWriter &) = delete;
+
+  void addEdge(NodeUID from, NodeUID to);
+  void close();
+
+  std::size_t edgeCount() const { return edge_count; }
+
+private:
+  int fd;
+  std::size_t node_count;
+  std::size_t edge_count = 0;
+  bool directed;
+  std::size_t block_edges;
+  std::vector<StreamedEdge> buffer;
+
+  void flush();
+};
+
+/*
+ * The EdgeStream struct is a graph source that reads its edges from an edge
+ * stream file instead of holding them in memory. It is the out-of-core
+ * counterpart to the in-memory Graph.
+ *
+ * forEachBlock() makes one sequential pass over the file and calls the visitor
+ * once per block. Blocks are read with pread() from a background task into one
+ * of two buffers, while the visitor works on the other one. The span passed to
+ * the visitor is only valid for the duration of the call.
+ *
+ * The constructor throws std::runtime_error if the file size does not match
+ * the header. forEachBlock() throws std::runtime_error on an edge whose
+ * endpoints are not below nodeCount(), before the visitor sees that block.
+ *
+ * The stream is stateless between passes, so several passes (and several
+ * concurrent passes from different threads) are fine.
+ */
+struct EdgeStream {
+  explicit EdgeStream(const std::string &path,
+                      std::size_t block_edges = kDefaultEdgeBlockSize);
+  ~EdgeStream();
+
+  EdgeStream(const EdgeStream &) = delete;
+  EdgeStream &operator=(const EdgeStream &) = delete;
+  EdgeStream(EdgeStream &&) noexcept;
+
+  std::size_t nodeCount() const { return node_count; }
+  std::size_t edgeCount() const { return edge_count; }
+  bool isDirected() const { return directed; }
+
+  void forEachBlock(
+      const std::function<void(std::span<const StreamedEdge>)> &visit) const;
+
+private:
+  int fd;
+  std::size_t node_count;
+  std::size_t edge_count;
+  bool directed;
+  std::size_t block_edges;
+};
+
+/*
+ * Writes all edges of an in-memory graph into an edge stream file. The
+ * resulting stream is always directed; edges carrying the UNDIRECTED trait are
+ * written once in each direction. The node count is one more than the largest
+ * node UID referenced by the graph.
+ */
+void writeEdgeStream(const Graph &graph, const std::string &path,
+                     std::size_t block_edges = kDefaultEdgeBlockSize);
+
+#endif // !CORE_EDGE_STREAM_H
@@ -0,0 +1,53 @@
+/*
+ * Semi-external graph algorithms. They run on an EdgeStream and keep only
+ * O(|V|) state in memory, every pass over the edges is one sequential read of
+ * the edge stream file. Node UIDs index directly into the returned vectors.
+ *
+ * Undirected streams are treated as if every edge was stored in both
+ * directions.
+ *
+ *  Time and Space Complexity:
+ * - semiExternalBFS: O(d * |E|) I/O where d is the eccentricity of the
+ *   source, O(|V|) memory.
+ * - semiExternalConnectedComponents: a single pass, amortized O(log |V|) per
+ *   edge (path halving, linking under the smaller UID), O(|V|) memory.
+ * - semiExternalPageRank: one pass per iteration plus one to count the
+ *   out-degrees, O(|V|) memory.
+ */
+#ifndef CORE_SEMI_EXTERNAL_H
+#define CORE_SEMI_EXTERNAL_H
+
+#include "edge_stream.hh"
+#include "typenames.hh"
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+inline constexpr std::size_t kUnreachable =
+    std::numeric_limits<std::size_t>::max();
+
+/*
+ * Level synchronous breadth-first search. Returns the hop distance of every
+ * node from source, nodes that cannot be reached get kUnreachable.
+ * Throws std::out_of_range if source is not a node of the stream.
+ */
+std::vector<std::size_t> semiExternalBFS(const EdgeStream &stream,
+                                         NodeUID source);
+
+/*
+ * Weakly connected components using an in-memory union-find. Every node is
+ * labelled with the smallest node UID of its component.
+ */
+std::vector<NodeUID> semiExternalConnectedComponents(const EdgeStream &stream);
+
+/*
+ * PageRank by power iteration. The rank of dangling nodes is distributed
+ * uniformly. Stops after max_iterations or once the L1 distance between two
+ * iterations drops below tolerance. The returned ranks sum up to 1.
+ */
+std::vector<double> semiExternalPageRank(const EdgeStream &stream,
+                                         double damping = 0.85,
+                                         std::size_t max_iterations = 100,
+                                         double tolerance = 1e-6);
+
+#endif // !CORE_SEMI_EXTERNAL_H
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <any>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
 #include <vector>
 #include <unordered_map>
 
@@ -9,6 +12,8 @@
 #include "core/edge_containers_vector.hh"
 #include "core/edge_containers_map.hh"
 #include "core/graph.hh"
+#include "core/edge_stream.hh"
+#include "core/semi_external.hh"
 
 // Node tests
 TEST(NodeTest, DefaultConstructor) {
@@ -106,3 +111,256 @@ TEST(GraphTest, AddNodeAndEdge) {
     g.addEdge(edge);
     // You can add more checks if Graph exposes node/edge counts
 }
+
+
+// EdgeStream tests
+
+// Removes the stream file even when an ASSERT ends the test early
+struct TempStreamFile {
+    std::string path;
+    explicit TempStreamFile(const std::string &name)
+        : path((std::filesystem::temp_directory_path() / name).string()) {}
+    ~TempStreamFile() { std::filesystem::remove(path); }
+};
+
+static void writeRawStream(const std::string &path,
+                           const EdgeStreamHeader &header,
+                           const std::vector<StreamedEdge> &edges) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(edges.data()),
+              edges.size() * sizeof(StreamedEdge));
+}
+
+TEST(EdgeStreamTest, WriteAndReadBack) {
+    TempStreamFile file("edge_stream_roundtrip.bin");
+    {
+        EdgeStreamWriter writer(file.path, 4, true, 2);
+        writer.addEdge(0, 1);
+        writer.addEdge(1, 2);
+        writer.addEdge(2, 3);
+        writer.addEdge(3, 0);
+        writer.addEdge(1, 3);
+    }
+    // A block size of 2 forces several blocks and a partial last one
+    EdgeStream stream(file.path, 2);
+    EXPECT_EQ(stream.nodeCount(), 4);
+    EXPECT_EQ(stream.edgeCount(), 5);
+    EXPECT_TRUE(stream.isDirected());
+
+    std::vector<StreamedEdge> edges;
+    stream.forEachBlock([&](std::span<const StreamedEdge> block) {
+        EXPECT_LE(block.size(), 2);
+        edges.insert(edges.end(), block.begin(), block.end());
+    });
+    ASSERT_EQ(edges.size(), 5);
+    EXPECT_EQ(edges[4].from, 1);
+    EXPECT_EQ(edges[4].to, 3);
+}
+
+TEST(EdgeStreamTest, RejectsInvalidInput) {
+    TempStreamFile file("edge_stream_invalid.bin");
+    {
+        EdgeStreamWriter writer(file.path, 2, true);
+        EXPECT_THROW(writer.addEdge(0, 2), std::out_of_range);
+    }
+    {
+        std::ofstream out(file.path, std::ios::binary | std::ios::trunc);
+        out << "definitely not an edge stream header";
+    }
+    EXPECT_THROW(EdgeStream stream(file.path), std::runtime_error);
+}
+
+TEST(EdgeStreamTest, RejectsSizeMismatch) {
+    TempStreamFile file("edge_stream_size_mismatch.bin");
+    // Header claims two edges, the file only holds one
+    writeRawStream(file.path, {kEdgeStreamMagic, 2, 2, 1}, {{0, 1}});
+    EXPECT_THROW(EdgeStream stream(file.path), std::runtime_error);
+}
+
+TEST(EdgeStreamTest, RejectsEndpointOutOfRange) {
+    TempStreamFile file("edge_stream_bad_endpoint.bin");
+    writeRawStream(file.path, {kEdgeStreamMagic, 2, 2, 1},
+                   {{0, 1}, {0, 1000000}});
+    EdgeStream stream(file.path, 1);
+    std::size_t visited = 0;
+    EXPECT_THROW(stream.forEachBlock([&](std::span<const StreamedEdge> block) {
+        visited += block.size();
+    }),
+                 std::runtime_error);
+    // The bad record must never reach the visitor
+    EXPECT_EQ(visited, 1);
+    EXPECT_THROW(semiExternalConnectedComponents(stream), std::runtime_error);
+}
+
+TEST(EdgeStreamTest, TruncatedDuringPass) {
+    TempStreamFile file("edge_stream_truncated.bin");
+    {
+        EdgeStreamWriter writer(file.path, 3, true);
+        writer.addEdge(0, 1);
+        writer.addEdge(1, 2);
+        writer.addEdge(2, 0);
+    }
+    EdgeStream stream(file.path, 1);
+    // Shrinking the file after the size check makes the prefetch hit EOF
+    std::filesystem::resize_file(file.path,
+                                 sizeof(EdgeStreamHeader) + sizeof(StreamedEdge));
+    EXPECT_THROW(stream.forEachBlock([](std::span<const StreamedEdge>) {}),
+                 std::runtime_error);
+}
+
+TEST(EdgeStreamTest, VisitorThrowsMidPass) {
+    TempStreamFile file("edge_stream_visitor_throws.bin");
+    {
+        EdgeStreamWriter writer(file.path, 4, true);
+        writer.addEdge(0, 1);
+        writer.addEdge(1, 2);
+        writer.addEdge(2, 3);
+        writer.addEdge(3, 0);
+    }
+    EdgeStream stream(file.path, 1);
+    std::size_t blocks = 0;
+    // Leaves the prefetch of the third block in flight when unwinding
+    EXPECT_THROW(stream.forEachBlock([&](std::span<const StreamedEdge>) {
+        if (++blocks == 2) {
+            throw std::runtime_error("visitor failed");
+        }
+    }),
+                 std::runtime_error);
+
+    std::size_t edges = 0;
+    stream.forEachBlock(
+        [&](std::span<const StreamedEdge> block) { edges += block.size(); });
+    EXPECT_EQ(edges, 4);
+}
+
+TEST(EdgeStreamTest, WriteFromGraph) {
+    Graph g;
+    auto n0 = std::make_shared<Node>(0);
+    auto n1 = std::make_shared<Node>(1);
+    auto n2 = std::make_shared<Node>(2);
+    auto directed = std::make_shared<Edge>(
+        n0, n1, EdgeTraits{std::unordered_set<EdgeTypes>{EdgeTypes::DIRECTED}},
+        1.0);
+    directed->uid = 0;
+    auto undirected = std::make_shared<Edge>(
+        n1, n2,
+        EdgeTraits{std::unordered_set<EdgeTypes>{EdgeTypes::UNDIRECTED}}, 1.0);
+    undirected->uid = 1;
+    g.edge_list[directed->uid] = directed;
+    g.edge_list[undirected->uid] = undirected;
+
+    TempStreamFile file("edge_stream_graph.bin");
+    writeEdgeStream(g, file.path);
+    EdgeStream stream(file.path);
+    EXPECT_EQ(stream.nodeCount(), 3);
+    EXPECT_EQ(stream.edgeCount(), 3);
+    EXPECT_TRUE(stream.isDirected());
+}
+
+// Semi-external algorithm tests
+TEST(SemiExternalTest, BFSDirected) {
+    TempStreamFile file("semi_external_bfs.bin");
+    {
+        EdgeStreamWriter writer(file.path, 5, true, 1);
+        // Edges deliberately out of BFS order
+        writer.addEdge(2, 3);
+        writer.addEdge(1, 2);
+        writer.addEdge(0, 1);
+        writer.addEdge(0, 2);
+        writer.addEdge(4, 0);
+    }
+    EdgeStream stream(file.path, 1);
+    auto distance = semiExternalBFS(stream, 0);
+    EXPECT_EQ(distance, (std::vector<std::size_t>{0, 1, 1, 2, kUnreachable}));
+    EXPECT_THROW(semiExternalBFS(stream, 5), std::out_of_range);
+}
+
+TEST(SemiExternalTest, BFSUndirected) {
+    TempStreamFile file("semi_external_bfs_undirected.bin");
+    {
+        EdgeStreamWriter writer(file.path, 4, false);
+        writer.addEdge(1, 0);
+        writer.addEdge(2, 1);
+        writer.addEdge(3, 2);
+    }
+    EdgeStream stream(file.path);
+    EXPECT_EQ(semiExternalBFS(stream, 0),
+              (std::vector<std::size_t>{0, 1, 2, 3}));
+}
+
+TEST(SemiExternalTest, ConnectedComponents) {
+    TempStreamFile file("semi_external_cc.bin");
+    {
+        EdgeStreamWriter writer(file.path, 7, true, 2);
+        writer.addEdge(3, 1);
+        writer.addEdge(5, 3);
+        writer.addEdge(2, 4);
+        writer.addEdge(6, 4);
+    }
+    EdgeStream stream(file.path, 2);
+    EXPECT_EQ(semiExternalConnectedComponents(stream),
+              (std::vector<NodeUID>{0, 1, 2, 1, 2, 1, 2}));
+}
+
+TEST(SemiExternalTest, ConnectedComponentsUndirected) {
+    TempStreamFile file("semi_external_cc_undirected.bin");
+    {
+        EdgeStreamWriter writer(file.path, 6, false, 2);
+        writer.addEdge(5, 4);
+        writer.addEdge(4, 2);
+        writer.addEdge(3, 1);
+    }
+    EdgeStream stream(file.path, 2);
+    EXPECT_EQ(semiExternalConnectedComponents(stream),
+              (std::vector<NodeUID>{0, 1, 2, 1, 2, 2}));
+}
+
+TEST(SemiExternalTest, PageRank) {
+    TempStreamFile file("semi_external_pagerank.bin");
+    {
+        // Cycle 0 -> 1 -> 2 -> 0 with an extra edge 3 -> 0 into it. Nothing
+        // points to 3 or 4, so both only get the teleport share (4 is
+        // dangling), and rank decreases along the cycle starting at 0.
+        EdgeStreamWriter writer(file.path, 5, true, 2);
+        writer.addEdge(0, 1);
+        writer.addEdge(1, 2);
+        writer.addEdge(2, 0);
+        writer.addEdge(3, 0);
+    }
+    EdgeStream stream(file.path, 2);
+    auto rank = semiExternalPageRank(stream, 0.85, 200, 1e-12);
+    ASSERT_EQ(rank.size(), 5);
+    EXPECT_NEAR(std::accumulate(rank.begin(), rank.end(), 0.0), 1.0, 1e-9);
+    EXPECT_NEAR(rank[3], rank[4], 1e-9);
+    EXPECT_GT(rank[0], rank[2]);
+    EXPECT_GT(rank[2], rank[3]);
+}
+
+TEST(SemiExternalTest, PageRankUndirected) {
+    TempStreamFile undirected_file("semi_external_pagerank_undirected.bin");
+    TempStreamFile directed_file("semi_external_pagerank_both_ways.bin");
+    // Star around 0 plus the isolated, dangling node 4
+    const std::vector<std::pair<NodeUID, NodeUID>> edges{{0, 1}, {2, 0}, {0, 3}};
+    {
+        EdgeStreamWriter undirected(undirected_file.path, 5, false, 2);
+        EdgeStreamWriter directed(directed_file.path, 5, true, 2);
+        for (const auto &[from, to] : edges) {
+            undirected.addEdge(from, to);
+            directed.addEdge(from, to);
+            directed.addEdge(to, from);
+        }
+    }
+    // An undirected stream must rank exactly like storing both directions
+    auto rank = semiExternalPageRank(EdgeStream(undirected_file.path, 2), 0.85,
+                                     200, 1e-12);
+    auto expected = semiExternalPageRank(EdgeStream(directed_file.path, 2),
+                                         0.85, 200, 1e-12);
+    ASSERT_EQ(rank.size(), expected.size());
+    for (std::size_t node = 0; node < rank.size(); ++node) {
+        EXPECT_NEAR(rank[node], expected[node], 1e-12);
+    }
+    EXPECT_NEAR(std::accumulate(rank.begin(), rank.end(), 0.0), 1.0, 1e-9);
+    EXPECT_GT(rank[0], rank[1]);
+    EXPECT_NEAR(rank[1], rank[2], 1e-12);
+}